@@ -12,5 +12,9 @@
 // Just include things in the right order
 #include <clixx/base.h>
 #include <clixx/boards.h>
+#include <clixx/analog.h>
+#include <clixx/monitor.h>
+#include <clixx/buspolicy.h>
+#include <clixx/realtime.h>
 
 #endif /* __CLIXX_H */
@@ -0,0 +1,173 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Block based post-processing for samples read from Analog slots.
+*--------------------------------------------------------------------------*/
+#ifndef __CLIXX_ANALOG_H
+#define __CLIXX_ANALOG_H
+
+// Do some sanity checking
+#ifndef __CLIXX_H
+#  error "Do not include this file directly. Include <clixx.h> instead."
+#endif
+
+// Required definitions
+#include <stdint.h>
+
+/** Converts raw ADC counts into voltages
+ *
+ * The default conversion maps the full range of the ADC (as given by the
+ * resolution) onto the voltage level of the Slot. An additional gain and
+ * offset can be applied to trim out errors in the individual Slot.
+ */
+class AnalogCalibration {
+  public:
+    /** Constructor
+     *
+     * @param level the voltage level of the slot (one of Slot::Level).
+     * @param resolution the resolution of the ADC in bits (1 to 16).
+     */
+    AnalogCalibration(Slot::Level level, uint8_t resolution);
+
+    /** Set the trim values for this calibration
+     *
+     * @param gain the multiplier to apply to the nominal conversion.
+     * @param offset the value (in volts) to add after scaling.
+     */
+    void trim(float gain, float offset);
+
+    /** Convert a block of raw samples
+     *
+     * @param pInput pointer to the raw ADC values.
+     * @param pOutput pointer to the location to store the voltages.
+     * @param count the number of samples to convert.
+     */
+    void convert(const uint16_t *pInput, float *pOutput, int count);
+
+  private:
+    float m_scale;  //! Volts per ADC count (before trimming)
+    float m_gain;   //! Trim gain
+    float m_offset; //! Trim offset
+  };
+
+/** A second order IIR (biquad) filter
+ *
+ * Implemented as a transposed direct form II filter. The coefficients are
+ * normalised so that a0 is 1.0. Each output depends on the previous one so
+ * this filter is always processed one sample at a time.
+ */
+class AnalogIIR {
+  public:
+    /** Constructor
+     *
+     * @param b0 feed forward coefficient for x[n]
+     * @param b1 feed forward coefficient for x[n-1]
+     * @param b2 feed forward coefficient for x[n-2]
+     * @param a1 feedback coefficient for y[n-1]
+     * @param a2 feedback coefficient for y[n-2]
+     */
+    AnalogIIR(float b0, float b1, float b2, float a1, float a2);
+
+    /** Clear the filter history
+     */
+    void reset();
+
+    /** Filter a block of samples
+     *
+     * The input and output may point to the same buffer.
+     *
+     * @param pInput pointer to the samples to filter.
+     * @param pOutput pointer to the location to store the filtered samples.
+     * @param count the number of samples to process.
+     */
+    void process(const float *pInput, float *pOutput, int count);
+
+  private:
+    float m_b0, m_b1, m_b2; //! Feed forward coefficients
+    float m_a1, m_a2;       //! Feedback coefficients
+    float m_z1, m_z2;       //! Filter state
+  };
+
+/** An FIR filter with optional decimation
+ *
+ * The filter does not allocate any memory, the caller provides both the
+ * filter taps and a state buffer which must remain valid for the life of
+ * the filter. The state buffer must be able to hold (2 * taps) values.
+ *
+ * When a decimation factor greater than 1 is given only every n'th output
+ * is calculated so the cost of the filter drops accordingly. A filter with
+ * no taps passes the (decimated) samples through unchanged.
+ */
+class AnalogFIR {
+  public:
+    /** Constructor
+     *
+     * @param pTaps pointer to the filter coefficients.
+     * @param taps the number of coefficients.
+     * @param pState pointer to the state buffer (2 * taps values).
+     * @param decimate the decimation factor (1 for no decimation).
+     */
+    AnalogFIR(const float *pTaps, int taps, float *pState, int decimate = 1);
+
+    /** Clear the filter history
+     */
+    void reset();
+
+    /** Filter a block of samples
+     *
+     * The input and output may point to the same buffer.
+     *
+     * @param pInput pointer to the samples to filter.
+     * @param pOutput pointer to the location to store the filtered samples.
+     * @param count the number of input samples to process.
+     *
+     * @return the number of output samples generated.
+     */
+    int process(const float *pInput, float *pOutput, int count);
+
+  private:
+    const float *m_pTaps;  //! The filter coefficients
+    float       *m_pState; //! The delay line (duplicated for contiguous access)
+    int          m_taps;   //! Number of coefficients
+    int          m_pos;    //! Position of the newest sample in the delay line
+    int          m_factor; //! Decimation factor
+    int          m_phase;  //! Samples remaining until the next output
+  };
+
+/** Chains the post-processing stages for an Analog slot
+ *
+ * Raw samples are converted to volts, passed through the IIR filter (if
+ * any) and then through the FIR filter (if any). The stages are owned by
+ * the caller.
+ */
+class AnalogPipeline {
+  public:
+    /** Constructor
+     *
+     * @param pCalibration the calibration to apply to raw samples.
+     * @param pIIR the IIR filter to apply or NULL.
+     * @param pFIR the FIR filter (and decimation) to apply or NULL.
+     */
+    AnalogPipeline(AnalogCalibration *pCalibration, AnalogIIR *pIIR = 0, AnalogFIR *pFIR = 0);
+
+    /** Process a block of raw samples
+     *
+     * @param pInput pointer to the raw ADC values.
+     * @param pOutput pointer to the location to store the results. This
+     *                must be large enough to hold 'count' values.
+     * @param count the number of raw samples to process.
+     *
+     * @return the number of output samples generated.
+     */
+    int process(const uint16_t *pInput, float *pOutput, int count);
+
+  private:
+    AnalogCalibration *m_pCalibration; //! Conversion to volts
+    AnalogIIR         *m_pIIR;         //! Optional IIR stage
+    AnalogFIR         *m_pFIR;         //! Optional FIR stage
+  };
+
+#endif /* __CLIXX_ANALOG_H */
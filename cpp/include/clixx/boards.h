@@ -22,6 +22,12 @@
  */
 class DockImpl : public Dock {
   public:
+    /** Special return values for the block transfer methods */
+    enum {
+      TRANSFER_ERROR   = -1, //!< The transfer failed
+      TRANSFER_TIMEOUT = -2, //!< The transfer did not complete within the slot timeout
+      };
+
     /** Read a value from a digital slot
      *
      * @param slot the number of the slot to read from
@@ -63,16 +69,18 @@ class DockImpl : public Dock {
     /** Read a block of data from an I2C slot
      *
      * Will attempt to read up to 'count' bytes from the I2C slot. The read
-     * will complete if it times out. The caller must ensure that the memory
-     * pointed to by pBuffer is large enough to hold the data read.
+     * will complete with the data received so far if it times out, unless a
+     * timeout has been set with set_timeout(). The caller must ensure that
+     * the memory pointed to by pBuffer is large enough to hold the data read.
      *
      * @param slot the slot number to read from.
      * @param pBuffer pointer to the memory location to store data in.
      * @param offset offset into the buffer to start storing data.
      * @param count the maximum number of bytes to read.
      *
-     * @return the number of bytes that were actually read or -1 if an error
-     *         occurs.
+     * @return the number of bytes that were actually read, TRANSFER_ERROR
+     *         (-1) if an error occurs or TRANSFER_TIMEOUT (-2) if a timeout
+     *         set with set_timeout() expired.
      */
     int read_i2c(int slot, uint8_t *pBuffer, int offset, int count);
 
@@ -93,8 +101,9 @@ class DockImpl : public Dock {
      * @param offset offset into the buffer to start reading data.
      * @param count the maximum number of bytes to write.
      *
-     * @return the number of bytes that were actually written or -1 if an error
-     *         occurs.
+     * @return the number of bytes that were actually written, TRANSFER_ERROR
+     *         (-1) if an error occurs or TRANSFER_TIMEOUT (-2) if a timeout
+     *         set with set_timeout() expired.
      */
     int write_i2c(int slot, uint8_t *pBuffer, int offset, int count);
 
@@ -109,16 +118,18 @@ class DockImpl : public Dock {
     /** Read a block of data from an SPI slot
      *
      * Will attempt to read up to 'count' bytes from the I2C slot. The read
-     * will complete if it times out. The caller must ensure that the memory
-     * pointed to by pBuffer is large enough to hold the data read.
+     * will complete with the data received so far if it times out, unless a
+     * timeout has been set with set_timeout(). The caller must ensure that
+     * the memory pointed to by pBuffer is large enough to hold the data read.
      *
      * @param slot the slot number to read from.
      * @param pBuffer pointer to the memory location to store data in.
      * @param offset offset into the buffer to start storing data.
      * @param count the maximum number of bytes to read.
      *
-     * @return the number of bytes that were actually read or -1 if an error
-     *         occurs.
+     * @return the number of bytes that were actually read, TRANSFER_ERROR
+     *         (-1) if an error occurs or TRANSFER_TIMEOUT (-2) if a timeout
+     *         set with set_timeout() expired.
      */
     int read_spi(int slot, uint8_t *pBuffer, int offset, int count);
 
@@ -139,8 +150,9 @@ class DockImpl : public Dock {
      * @param offset offset into the buffer to start reading data.
      * @param count the maximum number of bytes to write.
      *
-     * @return the number of bytes that were actually written or -1 if an error
-     *         occurs.
+     * @return the number of bytes that were actually written, TRANSFER_ERROR
+     *         (-1) if an error occurs or TRANSFER_TIMEOUT (-2) if a timeout
+     *         set with set_timeout() expired.
      */
     int write_spi(int slot, uint8_t *pBuffer, int offset, int count);
 
@@ -189,6 +201,50 @@ class DockImpl : public Dock {
      *         occurs.
      */
     int write_serial(int slot, uint8_t *pBuffer, int offset, int count);
+
+    /** Set the timeout for transfers on a slot
+     *
+     * Sets the maximum time a single block read or write on the given slot
+     * may take before giving up. Once a timeout has been set a transfer that
+     * exceeds it returns TRANSFER_TIMEOUT rather than a partial count. Only
+     * meaningful for I2C and SPI slots.
+     *
+     * @param slot the number of the slot to configure.
+     * @param timeout the timeout in milliseconds. A value of 0 removes the
+     *                timeout and transfers behave as they did before.
+     */
+    void set_timeout(int slot, uint16_t timeout);
+
+    /** Get the timeout for transfers on a slot
+     *
+     * @param slot the number of the slot to query.
+     *
+     * @return the timeout in milliseconds, 0 if no timeout is set.
+     */
+    uint16_t get_timeout(int slot);
+
+    /** Attempt to recover a stuck I2C bus
+     *
+     * Performs the standard bus clear sequence - clock SCL (up to 9 times)
+     * until the slave releases SDA and then generate a STOP condition.
+     *
+     * @param slot the number of the I2C slot to recover.
+     *
+     * @return true if SDA was released and the bus is idle.
+     */
+    bool recover_i2c(int slot);
+
+    /** Get the current value of the system tick counter
+     *
+     * @return a free running millisecond counter. This will wrap around.
+     */
+    uint32_t get_ticks();
+
+    /** Wait for a number of milliseconds
+     *
+     * @param ticks the number of milliseconds to wait.
+     */
+    void wait_ticks(uint32_t ticks);
   };
 
 #endif // __CLIXX_BOARDS_H
@@ -0,0 +1,131 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Retry, timeout and recovery handling for I2C and SPI slots.
+*--------------------------------------------------------------------------*/
+#ifndef __CLIXX_BUSPOLICY_H
+#define __CLIXX_BUSPOLICY_H
+
+// Do some sanity checking
+#ifndef __CLIXX_H
+#  error "Do not include this file directly. Include <clixx.h> instead."
+#endif
+
+// Required definitions
+#include <stdint.h>
+
+/** Describes how failed transfers on a slot are handled
+ */
+struct BusPolicy {
+  uint16_t m_timeout;    //! Timeout for a single attempt (ms), 0 for no timeout
+  uint8_t  m_retries;    //! Number of retries after the first attempt
+  uint16_t m_backoff;    //! Delay before the first retry (ms), doubled each retry
+  uint16_t m_maxBackoff; //! Upper limit for the retry delay (ms)
+  uint8_t  m_tripCount;  //! Consecutive failed transfers before the slot is skipped (0 to disable)
+  uint16_t m_coolDown;   //! Time a tripped slot is skipped for (ms)
+  };
+
+/** Statistics collected by a BusGuard
+ */
+struct BusCounters {
+  uint32_t m_transfers;        //! Transfers requested
+  uint32_t m_attempts;         //! Attempts made (including retries)
+  uint32_t m_failures;         //! Transfers that failed after all retries
+  uint32_t m_timeouts;         //! Attempts that reported a timeout
+  uint32_t m_recoveries;       //! I2C bus clear sequences that freed the bus
+  uint32_t m_recoveryFailures; //! I2C bus clear sequences that did not free the bus
+  uint32_t m_skipped;          //! Transfers rejected because the slot was tripped
+  uint32_t m_trips;            //! Number of times the slot has been tripped
+  };
+
+/** Applies a BusPolicy to transfers on a single I2C or SPI slot
+ *
+ * Each transfer is attempted with the configured timeout. A transfer that
+ * returns an error or fewer bytes than requested is retried with an
+ * exponentially increasing delay between attempts. If an attempt on an I2C
+ * slot timed out a bus clear is performed before the retry. The policy
+ * timeout only applies while the guard is transferring, the previous slot
+ * timeout is restored afterwards so direct transfers are unaffected.
+ *
+ * If a number of consecutive transfers fail the slot is 'tripped' and all
+ * transfers are rejected immediately for the cool down period so a single
+ * faulty Tab does not hold up every other user of the bus. After the cool
+ * down a single transfer is allowed through, if it succeeds the slot is
+ * returned to normal operation, otherwise it is tripped again.
+ */
+class BusGuard {
+  public:
+    /** Constructor
+     *
+     * @param dock the Dock implementation to perform transfers with.
+     * @param slot the number of the slot to guard. For any type of slot other
+     *             than I2C or SPI all transfers will fail.
+     * @param policy the policy to apply. This is copied.
+     */
+    BusGuard(DockImpl &dock, int slot, const BusPolicy &policy);
+
+    /** Read a block of data from the slot
+     *
+     * @param pBuffer pointer to the memory location to store data in.
+     * @param offset offset into the buffer to start storing data.
+     * @param count the number of bytes to read.
+     *
+     * @return the number of bytes read or -1 if the transfer failed or the
+     *         slot is currently tripped.
+     */
+    int read(uint8_t *pBuffer, int offset, int count);
+
+    /** Write a block of data to the slot
+     *
+     * @param pBuffer pointer to the memory location to read data from.
+     * @param offset offset into the buffer to start reading data.
+     * @param count the number of bytes to write.
+     *
+     * @return the number of bytes written or -1 if the transfer failed or the
+     *         slot is currently tripped.
+     */
+    int write(uint8_t *pBuffer, int offset, int count);
+
+    /** Determine if the slot is currently tripped
+     *
+     * @return true if transfers are currently being rejected.
+     */
+    bool isTripped();
+
+    /** Clear the tripped state and the statistics
+     */
+    void reset();
+
+    /** Get the statistics for this slot
+     *
+     * @return a pointer to the counters maintained by this guard.
+     */
+    BusCounters *getCounters() {
+      return &m_counters;
+      }
+
+  private:
+    /** Signature shared by the DockImpl block transfer methods */
+    typedef int (DockImpl::*Transfer)(int slot, uint8_t *pBuffer, int offset, int count);
+
+    /** Perform a transfer with retries
+     */
+    int transfer(Transfer op, uint8_t *pBuffer, int offset, int count);
+
+  private:
+    DockImpl    &m_dock;     //! The Dock implementation
+    int          m_slot;     //! The slot being guarded
+    Slot::Type   m_type;     //! The type of the slot being guarded
+    Transfer     m_read;     //! Read method for the slot type (NULL if unsupported)
+    Transfer     m_write;    //! Write method for the slot type (NULL if unsupported)
+    BusPolicy    m_policy;   //! The policy in effect
+    BusCounters  m_counters; //! Statistics
+    uint8_t      m_failed;   //! Consecutive failed transfers
+    bool         m_tripped;  //! True if the slot has been tripped
+    uint32_t     m_resume;   //! Tick count when a tripped slot may be retried
+  };
+
+#endif /* __CLIXX_BUSPOLICY_H */
@@ -0,0 +1,124 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Change detection for Slot values.
+*--------------------------------------------------------------------------*/
+#ifndef __CLIXX_MONITOR_H
+#define __CLIXX_MONITOR_H
+
+// Do some sanity checking
+#ifndef __CLIXX_H
+#  error "Do not include this file directly. Include <clixx.h> instead."
+#endif
+
+// Required definitions
+#include <stdint.h>
+
+/** A single change reported by a SlotMonitor
+ */
+struct SlotEvent {
+  uint8_t  m_slot;  //! The slot number that changed
+  uint16_t m_value; //! The new value of the slot
+  };
+
+/** Tracks the values of a set of Slots and reports changes
+ *
+ * The monitor keeps the last reported value for each watched Slot. Each
+ * call to poll() samples the watched Slots and queues an event for every
+ * Slot whose value has moved by more than its deadband since the last
+ * reported value. Digital slots report every toggle. Only Analog and
+ * Digital slots can be watched, reading any other type of slot would take
+ * data away from the application.
+ *
+ * The event queue is a single producer, single consumer ring buffer so
+ * poll() can be called from a timer interrupt or a sampling thread while
+ * the application collects events in batches with fetch() - no locks are
+ * needed as long as there is only one of each. If the queue is full the
+ * change is held back (the last reported value is not updated) so it will
+ * be reported by a later poll() once there is space.
+ */
+class SlotMonitor {
+  public:
+    /** Limits for the monitor */
+    enum {
+      MAX_SLOTS  = 16, //!< Maximum slot number that can be watched (exclusive)
+      QUEUE_SIZE = 32, //!< Number of events that can be queued (power of 2)
+      };
+
+    /** Constructor
+     *
+     * @param dock the Dock containing the slots to monitor.
+     */
+    SlotMonitor(Dock &dock);
+
+    /** Start watching a slot
+     *
+     * The current value of the slot will be reported on the next poll.
+     * This should not be called while poll() may be running.
+     *
+     * @param slot the number of the slot to watch.
+     * @param deadband the amount the value must change by before it is
+     *                 reported. Ignored for digital slots.
+     *
+     * @return true if the slot is now being watched, false if the slot
+     *         number is invalid or the slot is not Analog or Digital.
+     */
+    bool watch(int slot, uint16_t deadband = 0);
+
+    /** Stop watching a slot
+     *
+     * This should not be called while poll() may be running.
+     *
+     * @param slot the number of the slot to stop watching.
+     */
+    void unwatch(int slot);
+
+    /** Sample the watched slots
+     *
+     * This is the producer side of the queue and should only be called from
+     * a single context (the main loop, a timer interrupt or a thread).
+     *
+     * @return the number of events added to the queue.
+     */
+    int poll();
+
+    /** Collect queued events
+     *
+     * This is the consumer side of the queue and should only be called from
+     * a single context.
+     *
+     * @param pEvents pointer to the location to store the events in.
+     * @param count the maximum number of events to collect.
+     *
+     * @return the number of events stored in pEvents.
+     */
+    int fetch(SlotEvent *pEvents, int count);
+
+    /** Get the number of changes held back due to a full queue
+     *
+     * A change is counted once when it is first held back, no matter how
+     * many polls it takes before there is room to report it.
+     *
+     * @return the number of deferred changes since the monitor was created.
+     */
+    uint16_t getDeferred() {
+      return m_deferred;
+      }
+
+  private:
+    Dock              &m_dock;                  //! The Dock being monitored
+    uint16_t           m_watched;               //! Bitmask of watched slots
+    uint16_t           m_primed;                //! Bitmask of slots with a reported value
+    uint16_t           m_held;                  //! Bitmask of slots with a change held back
+    uint16_t           m_deferred;              //! Changes held back by a full queue
+    uint16_t           m_last[MAX_SLOTS];       //! Last reported value for each slot
+    uint16_t           m_deadband[MAX_SLOTS];   //! Deadband for each slot
+    SlotEvent          m_queue[QUEUE_SIZE];     //! Pending events
+    volatile uint8_t   m_head;                  //! Next entry to write (producer)
+    volatile uint8_t   m_tail;                  //! Next entry to read (consumer)
+  };
+
+#endif /* __CLIXX_MONITOR_H */
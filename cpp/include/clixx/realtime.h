@@ -0,0 +1,95 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Real time scheduling configuration for acquisition threads.
+*--------------------------------------------------------------------------*/
+#ifndef __CLIXX_REALTIME_H
+#define __CLIXX_REALTIME_H
+
+// Do some sanity checking
+#ifndef __CLIXX_H
+#  error "Do not include this file directly. Include <clixx.h> instead."
+#endif
+
+// Required definitions
+#include <stdint.h>
+
+/** Scheduling settings for a thread that services a bus or slot
+ */
+struct RealTimeConfig {
+  int      m_cpu;        //! CPU to run on, -1 to leave the affinity unchanged
+  int      m_priority;   //! SCHED_FIFO priority (1 to 99), 0 to leave the policy unchanged
+  bool     m_lockMemory; //! Lock all current and future pages into memory
+  uint32_t m_prefault;   //! Number of bytes of stack to touch in advance (must fit in the thread stack)
+  };
+
+/** Results from the latency probe (all values in microseconds)
+ */
+struct LatencyReport {
+  uint32_t m_samples; //! Number of wakeups measured
+  uint32_t m_min;     //! Smallest wakeup delay seen
+  uint32_t m_average; //! Average wakeup delay
+  uint32_t m_max;     //! Largest wakeup delay seen
+  };
+
+/** Applies real time settings and measures scheduling latency
+ *
+ * These are only available on hosted (Linux) boards such as the Raspberry
+ * Pi and the ClixxDock host. On microcontroller boards there is no scheduler
+ * to configure and all methods return false.
+ */
+class RealTime {
+  public:
+    /** Apply settings to the calling thread
+     *
+     * Each setting is attempted even if an earlier one fails. A prefault size
+     * that would not leave at least 64K of the thread stack free is rejected
+     * and nothing is touched. Setting a real time priority or locking memory
+     * generally requires root privileges (or the CAP_SYS_NICE and
+     * CAP_IPC_LOCK capabilities).
+     *
+     * @param config the settings to apply.
+     *
+     * @return true if all the requested settings were applied.
+     */
+    static bool apply(const RealTimeConfig &config);
+
+    /** Touch every page of a buffer so it is resident before use
+     *
+     * @param pBuffer pointer to the buffer to prefault.
+     * @param size the size of the buffer in bytes.
+     */
+    static void prefault(void *pBuffer, uint32_t size);
+
+    /** Measure wakeup latency for the calling thread
+     *
+     * Sleeps until a series of absolute deadlines and records how late each
+     * wakeup was. Run this after apply() to see what the settings achieved.
+     *
+     * @param interval the time between wakeups in microseconds.
+     * @param samples the number of wakeups to measure.
+     * @param pReport pointer to the structure to store the results in.
+     *
+     * @return true if the measurement was made. If false is returned all the
+     *         fields of the report are zero.
+     */
+    static bool probe(uint32_t interval, uint32_t samples, LatencyReport *pReport);
+
+    /** Apply settings and report the latency achieved
+     *
+     * A convenience method for use at startup, equivalent to calling apply()
+     * followed by probe() with a 1ms interval for 1000 samples.
+     *
+     * @param config the settings to apply.
+     * @param pReport pointer to the structure to store the results in.
+     *
+     * @return true if all the settings were applied and the measurement
+     *         was made.
+     */
+    static bool check(const RealTimeConfig &config, LatencyReport *pReport);
+  };
+
+#endif /* __CLIXX_REALTIME_H */
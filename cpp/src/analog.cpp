@@ -0,0 +1,225 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Implements the block based post-processing stages for Analog slots. The
+* inner loops use SSE2 or NEON where the compiler supports them and fall
+* back to plain C on everything else (AVR, Cortex-M0, etc).
+*--------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <clixx.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define CLIXX_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define CLIXX_SIMD_NEON
+#endif
+
+//---------------------------------------------------------------------------
+// Block kernels
+//---------------------------------------------------------------------------
+
+/** Scale a block of raw values
+ *
+ * Calculates pOutput[i] = (pInput[i] * scale) + offset
+ */
+static void kernel_scale(const uint16_t *pInput, float *pOutput, int count, float scale, float offset) {
+  int index = 0;
+#if defined(CLIXX_SIMD_SSE2)
+  __m128 vscale = _mm_set1_ps(scale);
+  __m128 voffset = _mm_set1_ps(offset);
+  __m128i zero = _mm_setzero_si128();
+  for(; (index + 8) <= count; index += 8) {
+    __m128i raw = _mm_loadu_si128((const __m128i *)(pInput + index));
+    __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, zero));
+    __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(raw, zero));
+    _mm_storeu_ps(pOutput + index, _mm_add_ps(_mm_mul_ps(lo, vscale), voffset));
+    _mm_storeu_ps(pOutput + index + 4, _mm_add_ps(_mm_mul_ps(hi, vscale), voffset));
+    }
+#elif defined(CLIXX_SIMD_NEON)
+  float32x4_t voffset = vdupq_n_f32(offset);
+  for(; (index + 8) <= count; index += 8) {
+    uint16x8_t raw = vld1q_u16(pInput + index);
+    float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(raw)));
+    float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(raw)));
+    vst1q_f32(pOutput + index, vmlaq_n_f32(voffset, lo, scale));
+    vst1q_f32(pOutput + index + 4, vmlaq_n_f32(voffset, hi, scale));
+    }
+#endif
+  // Handle whatever is left over
+  for(; index < count; index++)
+    pOutput[index] = ((float)pInput[index] * scale) + offset;
+  }
+
+/** Calculate the dot product of two blocks
+ */
+static float kernel_dot(const float *pA, const float *pB, int count) {
+  int index = 0;
+  float result = 0.0f;
+#if defined(CLIXX_SIMD_SSE2)
+  __m128 sum = _mm_setzero_ps();
+  for(; (index + 4) <= count; index += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pA + index), _mm_loadu_ps(pB + index)));
+  float lanes[4];
+  _mm_storeu_ps(lanes, sum);
+  result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(CLIXX_SIMD_NEON)
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for(; (index + 4) <= count; index += 4)
+    sum = vmlaq_f32(sum, vld1q_f32(pA + index), vld1q_f32(pB + index));
+  float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  result = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+  // Handle whatever is left over
+  for(; index < count; index++)
+    result += pA[index] * pB[index];
+  return result;
+  }
+
+//---------------------------------------------------------------------------
+// Implementation of AnalogCalibration
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+AnalogCalibration::AnalogCalibration(Slot::Level level, uint8_t resolution) {
+  float volts = (level & Slot::V050) ? 5.0f : 3.3f;
+  if((resolution < 1) || (resolution > 16))
+    resolution = 16;
+  m_scale = volts / (float)((1UL << resolution) - 1);
+  m_gain = 1.0f;
+  m_offset = 0.0f;
+  }
+
+/** Set the trim values for this calibration
+ */
+void AnalogCalibration::trim(float gain, float offset) {
+  m_gain = gain;
+  m_offset = offset;
+  }
+
+/** Convert a block of raw samples
+ */
+void AnalogCalibration::convert(const uint16_t *pInput, float *pOutput, int count) {
+  kernel_scale(pInput, pOutput, count, m_scale * m_gain, m_offset);
+  }
+
+//---------------------------------------------------------------------------
+// Implementation of AnalogIIR
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+AnalogIIR::AnalogIIR(float b0, float b1, float b2, float a1, float a2) {
+  m_b0 = b0;
+  m_b1 = b1;
+  m_b2 = b2;
+  m_a1 = a1;
+  m_a2 = a2;
+  reset();
+  }
+
+/** Clear the filter history
+ */
+void AnalogIIR::reset() {
+  m_z1 = 0.0f;
+  m_z2 = 0.0f;
+  }
+
+/** Filter a block of samples
+ */
+void AnalogIIR::process(const float *pInput, float *pOutput, int count) {
+  // Keep the state in locals for the duration of the block
+  float z1 = m_z1, z2 = m_z2;
+  for(int index = 0; index < count; index++) {
+    float x = pInput[index];
+    float y = (m_b0 * x) + z1;
+    z1 = (m_b1 * x) - (m_a1 * y) + z2;
+    z2 = (m_b2 * x) - (m_a2 * y);
+    pOutput[index] = y;
+    }
+  m_z1 = z1;
+  m_z2 = z2;
+  }
+
+//---------------------------------------------------------------------------
+// Implementation of AnalogFIR
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+AnalogFIR::AnalogFIR(const float *pTaps, int taps, float *pState, int decimate) {
+  m_pTaps = pTaps;
+  m_pState = pState;
+  m_taps = (taps < 1) ? 0 : taps;
+  m_factor = (decimate < 1) ? 1 : decimate;
+  reset();
+  }
+
+/** Clear the filter history
+ */
+void AnalogFIR::reset() {
+  for(int index = 0; index < (2 * m_taps); index++)
+    m_pState[index] = 0.0f;
+  m_pos = 0;
+  m_phase = m_factor;
+  }
+
+/** Filter a block of samples
+ *
+ * Each sample is stored twice in the delay line (at pos and pos + taps) so
+ * the most recent 'taps' samples are always contiguous starting at pos,
+ * newest first. This lets the dot product run over a single linear block.
+ */
+int AnalogFIR::process(const float *pInput, float *pOutput, int count) {
+  int outputs = 0;
+  for(int index = 0; index < count; index++) {
+    // Without any taps the samples are just decimated
+    if(m_taps == 0) {
+      if(--m_phase > 0)
+        continue;
+      m_phase = m_factor;
+      pOutput[outputs++] = pInput[index];
+      continue;
+      }
+    // Add the sample to the delay line
+    m_pos = (m_pos == 0) ? (m_taps - 1) : (m_pos - 1);
+    m_pState[m_pos] = pInput[index];
+    m_pState[m_pos + m_taps] = pInput[index];
+    // Only calculate the outputs we are going to keep
+    if(--m_phase > 0)
+      continue;
+    m_phase = m_factor;
+    pOutput[outputs++] = kernel_dot(m_pTaps, m_pState + m_pos, m_taps);
+    }
+  return outputs;
+  }
+
+//---------------------------------------------------------------------------
+// Implementation of AnalogPipeline
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+AnalogPipeline::AnalogPipeline(AnalogCalibration *pCalibration, AnalogIIR *pIIR, AnalogFIR *pFIR) {
+  m_pCalibration = pCalibration;
+  m_pIIR = pIIR;
+  m_pFIR = pFIR;
+  }
+
+/** Process a block of raw samples
+ *
+ * All stages after the calibration work in place on the output buffer.
+ */
+int AnalogPipeline::process(const uint16_t *pInput, float *pOutput, int count) {
+  m_pCalibration->convert(pInput, pOutput, count);
+  if(m_pIIR != NULL)
+    m_pIIR->process(pOutput, pOutput, count);
+  if(m_pFIR != NULL)
+    count = m_pFIR->process(pOutput, pOutput, count);
+  return count;
+  }
@@ -0,0 +1,130 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Implements retry, timeout and recovery handling for I2C and SPI slots.
+*--------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <clixx.h>
+
+//---------------------------------------------------------------------------
+// Implementation of BusGuard
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+BusGuard::BusGuard(DockImpl &dock, int slot, const BusPolicy &policy) : m_dock(dock) {
+  m_slot = slot;
+  m_policy = policy;
+  m_type = dock.getSlot(slot).getType();
+  // Select the transfer methods for the type of slot
+  switch(m_type) {
+    case Slot::TwoWire:
+      m_read = &DockImpl::read_i2c;
+      m_write = &DockImpl::write_i2c;
+      break;
+    case Slot::SPI:
+      m_read = &DockImpl::read_spi;
+      m_write = &DockImpl::write_spi;
+      break;
+    default:
+      m_read = NULL;
+      m_write = NULL;
+      break;
+    }
+  reset();
+  }
+
+/** Read a block of data from the slot
+ */
+int BusGuard::read(uint8_t *pBuffer, int offset, int count) {
+  return transfer(m_read, pBuffer, offset, count);
+  }
+
+/** Write a block of data to the slot
+ */
+int BusGuard::write(uint8_t *pBuffer, int offset, int count) {
+  return transfer(m_write, pBuffer, offset, count);
+  }
+
+/** Determine if the slot is currently tripped
+ */
+bool BusGuard::isTripped() {
+  if(!m_tripped)
+    return false;
+  // Compare as a signed difference so tick wrap around is handled
+  return (int32_t)(m_dock.get_ticks() - m_resume) < 0;
+  }
+
+/** Clear the tripped state and the statistics
+ */
+void BusGuard::reset() {
+  memset(&m_counters, 0, sizeof(m_counters));
+  m_failed = 0;
+  m_tripped = false;
+  m_resume = 0;
+  }
+
+/** Perform a transfer with retries
+ *
+ * A transfer is only considered successful if all the requested bytes are
+ * moved, a partial transfer is retried from the start. An I2C bus clear is
+ * only attempted after a timeout, a NACK does not indicate a stuck bus.
+ */
+int BusGuard::transfer(Transfer op, uint8_t *pBuffer, int offset, int count) {
+  if(op == NULL)
+    return DockImpl::TRANSFER_ERROR;
+  m_counters.m_transfers++;
+  if(isTripped()) {
+    m_counters.m_skipped++;
+    return DockImpl::TRANSFER_ERROR;
+    }
+  uint16_t timeout = m_dock.get_timeout(m_slot);
+  m_dock.set_timeout(m_slot, m_policy.m_timeout);
+  uint32_t backoff = m_policy.m_backoff;
+  if(backoff > m_policy.m_maxBackoff)
+    backoff = m_policy.m_maxBackoff;
+  int result = DockImpl::TRANSFER_ERROR;
+  for(int attempt = 0; attempt <= m_policy.m_retries; attempt++) {
+    // Wait before retrying
+    if(attempt > 0) {
+      if((m_type == Slot::TwoWire) && (result == DockImpl::TRANSFER_TIMEOUT)) {
+        if(m_dock.recover_i2c(m_slot))
+          m_counters.m_recoveries++;
+        else
+          m_counters.m_recoveryFailures++;
+        }
+      m_dock.wait_ticks(backoff);
+      backoff = backoff * 2;
+      if(backoff > m_policy.m_maxBackoff)
+        backoff = m_policy.m_maxBackoff;
+      }
+    // Make the attempt
+    m_counters.m_attempts++;
+    result = (m_dock.*op)(m_slot, pBuffer, offset, count);
+    if(result == DockImpl::TRANSFER_TIMEOUT)
+      m_counters.m_timeouts++;
+    if(result == count)
+      break;
+    }
+  // Put back whatever timeout the slot had before
+  m_dock.set_timeout(m_slot, timeout);
+  if(result == count) {
+    m_failed = 0;
+    m_tripped = false;
+    return result;
+    }
+  // All attempts failed, see if the slot should be tripped
+  m_counters.m_failures++;
+  if(m_failed < 0xFF)
+    m_failed++;
+  if(m_tripped || ((m_policy.m_tripCount > 0) && (m_failed >= m_policy.m_tripCount))) {
+    m_tripped = true;
+    m_resume = m_dock.get_ticks() + m_policy.m_coolDown;
+    m_counters.m_trips++;
+    }
+  return DockImpl::TRANSFER_ERROR;
+  }
@@ -0,0 +1,124 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Implements change detection and deadband reporting for Slot values.
+*--------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <clixx.h>
+
+/** Make queue updates visible to the other side before moving the index.
+ *
+ * On single core targets this only needs to stop the compiler reordering
+ * the accesses, on multi-core hosts (Raspberry Pi 2 and up) it is a full
+ * hardware barrier.
+ */
+#define QUEUE_BARRIER() __sync_synchronize()
+
+//---------------------------------------------------------------------------
+// Implementation of SlotMonitor
+//---------------------------------------------------------------------------
+
+/** Constructor
+ */
+SlotMonitor::SlotMonitor(Dock &dock) : m_dock(dock) {
+  m_watched = 0;
+  m_primed = 0;
+  m_held = 0;
+  m_deferred = 0;
+  m_head = 0;
+  m_tail = 0;
+  }
+
+/** Start watching a slot
+ */
+bool SlotMonitor::watch(int slot, uint16_t deadband) {
+  if((slot < 0) || (slot >= MAX_SLOTS) || (slot >= m_dock.getSlots()))
+    return false;
+  // Reading any other type of slot would consume data from it
+  Slot::Type type = m_dock.getSlot(slot).getType();
+  if((type != Slot::Analog) && (type != Slot::Digital))
+    return false;
+  m_deadband[slot] = deadband;
+  m_primed &= ~(1 << slot);
+  m_held &= ~(1 << slot);
+  m_watched |= (1 << slot);
+  return true;
+  }
+
+/** Stop watching a slot
+ */
+void SlotMonitor::unwatch(int slot) {
+  if((slot < 0) || (slot >= MAX_SLOTS))
+    return;
+  m_watched &= ~(1 << slot);
+  }
+
+/** Sample the watched slots
+ */
+int SlotMonitor::poll() {
+  int added = 0;
+  uint8_t head = m_head;
+  for(int slot = 0; slot < MAX_SLOTS; slot++) {
+    uint16_t mask = 1 << slot;
+    if(!(m_watched & mask))
+      continue;
+    Slot &target = m_dock.getSlot(slot);
+    uint16_t value = target.read();
+    // Decide if this is a change worth reporting
+    if(m_primed & mask) {
+      uint16_t last = m_last[slot];
+      bool changed;
+      if(target.getType() == Slot::Digital)
+        changed = (value != last);
+      else
+        changed = (((value > last) ? (value - last) : (last - value)) > m_deadband[slot]);
+      if(!changed) {
+        m_held &= ~mask;
+        continue;
+        }
+      }
+    // Make sure there is room in the queue, only count each change once
+    if((uint8_t)(head - m_tail) >= QUEUE_SIZE) {
+      if(!(m_held & mask)) {
+        m_held |= mask;
+        m_deferred++;
+        }
+      continue;
+      }
+    m_held &= ~mask;
+    m_queue[head & (QUEUE_SIZE - 1)].m_slot = slot;
+    m_queue[head & (QUEUE_SIZE - 1)].m_value = value;
+    head++;
+    added++;
+    m_last[slot] = value;
+    m_primed |= mask;
+    }
+  // Publish all the new events at once
+  if(added > 0) {
+    QUEUE_BARRIER();
+    m_head = head;
+    }
+  return added;
+  }
+
+/** Collect queued events
+ */
+int SlotMonitor::fetch(SlotEvent *pEvents, int count) {
+  int fetched = 0;
+  uint8_t tail = m_tail;
+  uint8_t head = m_head;
+  QUEUE_BARRIER();
+  while((tail != head) && (fetched < count)) {
+    pEvents[fetched++] = m_queue[tail & (QUEUE_SIZE - 1)];
+    tail++;
+    }
+  // Release the entries back to the producer
+  if(fetched > 0) {
+    QUEUE_BARRIER();
+    m_tail = tail;
+    }
+  return fetched;
+  }
@@ -0,0 +1,183 @@
+/*--------------------------------------------------------------------------*
+* ClixxLib - Copyright (c) 2013, Shane Gough (shane@thegaragelab.com)
+*            For licensing information see COPYING in the project root.
+*---------------------------------------------------------------------------*
+* 19-Oct-2026 agent
+*
+* Implements real time scheduling configuration and the latency probe. Only
+* hosted Linux boards provide an implementation, everything else gets stubs.
+*--------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <clixx.h>
+
+#if defined(__linux__)
+#  include <alloca.h>
+#  include <pthread.h>
+#  include <errno.h>
+#  include <sched.h>
+#  include <time.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#endif
+
+/** Wakeup interval used by check() (microseconds) */
+#define CHECK_INTERVAL 1000
+
+/** Number of wakeups measured by check() */
+#define CHECK_SAMPLES  1000
+
+/** Stack that must remain free after prefaulting (bytes) */
+#define STACK_HEADROOM (64 * 1024)
+
+//---------------------------------------------------------------------------
+// Implementation of RealTime
+//---------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+/** Determine how much of the calling thread's stack is still unused
+ *
+ * @return the number of bytes between the current stack position and the
+ *         end of the stack or 0 if it cannot be determined.
+ */
+static uint32_t stack_available() {
+  pthread_attr_t attr;
+  void *pStack;
+  size_t size;
+  if(pthread_getattr_np(pthread_self(), &attr) != 0)
+    return 0;
+  int result = pthread_attr_getstack(&attr, &pStack, &size);
+  pthread_attr_destroy(&attr);
+  if(result != 0)
+    return 0;
+  // The stack grows down towards pStack
+  uint8_t marker;
+  uintptr_t used = (uintptr_t)&marker - (uintptr_t)pStack;
+  return (used > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)used;
+  }
+
+/** Apply settings to the calling thread
+ */
+bool RealTime::apply(const RealTimeConfig &config) {
+  bool result = true;
+  // Pin to a single CPU
+  if(config.m_cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(config.m_cpu, &cpus);
+    result &= (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0);
+    }
+  // Switch to the FIFO scheduler
+  if(config.m_priority > 0) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = config.m_priority;
+    result &= (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+    }
+  // Keep everything resident
+  if(config.m_lockMemory)
+    result &= (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+  // Touch the stack we expect to use so it is mapped now rather than later,
+  // refusing any request that would overflow the stack
+  if(config.m_prefault > 0) {
+    uint32_t available = stack_available();
+    if((available <= STACK_HEADROOM) || (config.m_prefault > (available - STACK_HEADROOM)))
+      result = false;
+    else
+      prefault(alloca(config.m_prefault), config.m_prefault);
+    }
+  return result;
+  }
+
+/** Touch every page of a buffer so it is resident before use
+ */
+void RealTime::prefault(void *pBuffer, uint32_t size) {
+  volatile uint8_t *pData = (volatile uint8_t *)pBuffer;
+  uint32_t page = (uint32_t)sysconf(_SC_PAGESIZE);
+  for(uint32_t offset = 0; offset < size; offset += page)
+    pData[offset] = pData[offset];
+  if(size > 0)
+    pData[size - 1] = pData[size - 1];
+  }
+
+/** Measure wakeup latency for the calling thread
+ */
+bool RealTime::probe(uint32_t interval, uint32_t samples, LatencyReport *pReport) {
+  if(pReport == NULL)
+    return false;
+  pReport->m_samples = 0;
+  pReport->m_min = 0;
+  pReport->m_average = 0;
+  pReport->m_max = 0;
+  if(samples == 0)
+    return false;
+  uint64_t total = 0;
+  uint32_t least = 0xFFFFFFFF, most = 0;
+  // Split the interval so the arithmetic fits in a 32 bit long
+  time_t stepSeconds = (time_t)(interval / 1000000);
+  long stepNanos = (long)(interval % 1000000) * 1000L;
+  struct timespec deadline, now;
+  if(clock_gettime(CLOCK_MONOTONIC, &deadline) != 0)
+    return false;
+  for(uint32_t sample = 0; sample < samples; sample++) {
+    // Move to the next deadline
+    deadline.tv_sec += stepSeconds;
+    deadline.tv_nsec += stepNanos;
+    if(deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_nsec -= 1000000000L;
+      deadline.tv_sec++;
+      }
+    // The deadline is absolute so it is safe to restart after a signal
+    int status;
+    do {
+      status = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+      } while(status == EINTR);
+    if(status != 0)
+      return false;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    // Work out how late we are
+    int64_t late = ((int64_t)(now.tv_sec - deadline.tv_sec) * 1000000000LL) + (now.tv_nsec - deadline.tv_nsec);
+    uint32_t delay = (late > 0) ? (uint32_t)(late / 1000) : 0;
+    if(delay < least)
+      least = delay;
+    if(delay > most)
+      most = delay;
+    total += delay;
+    }
+  pReport->m_samples = samples;
+  pReport->m_min = least;
+  pReport->m_max = most;
+  pReport->m_average = (uint32_t)(total / samples);
+  return true;
+  }
+
+#else
+
+/** Apply settings to the calling thread
+ */
+bool RealTime::apply(const RealTimeConfig &) {
+  return false;
+  }
+
+/** Touch every page of a buffer so it is resident before use
+ */
+void RealTime::prefault(void *, uint32_t) {
+  // Nothing to do here
+  }
+
+/** Measure wakeup latency for the calling thread
+ */
+bool RealTime::probe(uint32_t, uint32_t, LatencyReport *) {
+  return false;
+  }
+
+#endif
+
+/** Apply settings and report the latency achieved
+ */
+bool RealTime::check(const RealTimeConfig &config, LatencyReport *pReport) {
+  bool result = apply(config);
+  result &= probe(CHECK_INTERVAL, CHECK_SAMPLES, pReport);
+  return result;
+  }
@@ -0,0 +1,144 @@
+#!/usr/bin/env python
+#----------------------------------------------------------------------------
+# SmartDock emulator on a local pseudo terminal.
+#----------------------------------------------------------------------------
+import os
+import pty
+import tty
+import threading
+import time
+from clixxbase import Dock, Slot
+
+# Default slots provided by the emulator
+DEFAULT_SLOTS = (
+  (Dock.DIGITAL_0, Slot.DIGITAL, Slot.SINGLETAB),
+  (Dock.DIGITAL_1, Slot.DIGITAL, Slot.TWINTAB),
+  (Dock.ANALOG_0,  Slot.ANALOG,  Slot.SINGLETAB),
+  (Dock.ANALOG_1,  Slot.ANALOG,  Slot.SINGLETAB),
+  )
+
+class SmartDockEmulator:
+  """ Emulates a SmartDock on a pseudo terminal.
+
+    Start the emulator and pass the 'port' attribute to SmartDock.setup().
+    Each slot simply holds the last value written to it, values can also
+    be changed directly with set(). The number of frames processed is kept
+    in the 'frames' attribute and setting 'delay' (in seconds) holds back
+    each response to simulate a slow dock.
+
+      emulator = SmartDockEmulator()
+      emulator.start()
+      dock = SmartDock()
+      dock.setup(port = emulator.port)
+  """
+
+  def __init__(self, slots = DEFAULT_SLOTS):
+    """ Initialise the emulator
+    """
+    self.slots = slots
+    self.values = dict([ (info[0], 0) for info in slots ])
+    self.frames = 0
+    self.delay = 0
+    self.port = None
+    self.master = None
+    self.slave = None
+    self.thread = None
+
+  def start(self):
+    """ Create the pseudo terminal and start processing commands
+    """
+    self.master, self.slave = pty.openpty()
+    tty.setraw(self.slave)
+    self.port = os.ttyname(self.slave)
+    self.thread = threading.Thread(target = self.run)
+    self.thread.daemon = True
+    self.thread.start()
+
+  def stop(self):
+    """ Shut down the emulator
+    """
+    if self.master is not None:
+      os.close(self.slave)
+      os.close(self.master)
+      self.master = None
+      self.slave = None
+    if self.thread is not None:
+      self.thread.join(1.0)
+      self.thread = None
+
+  def set(self, name, value):
+    """ Change the value of a slot
+    """
+    self.values[name] = value
+
+  def get(self, name):
+    """ Get the current value of a slot
+    """
+    return self.values[name]
+
+  #--------------------------------------------------------------------------
+  # Implementation
+  #--------------------------------------------------------------------------
+
+  def run(self):
+    """ Read frames from the pseudo terminal and send responses
+    """
+    master = self.master
+    pending = ""
+    while True:
+      try:
+        data = os.read(master, 1024)
+      except OSError:
+        return
+      if len(data) == 0:
+        return
+      pending = pending + data.decode("ascii")
+      while "\n" in pending:
+        frame, pending = pending.split("\n", 1)
+        commands = frame.strip().split(";")
+        results = list()
+        # Echo back the sequence tag if there is one
+        if commands[0].startswith("@"):
+          results.append(commands.pop(0))
+        results.extend([ self.process(command) for command in commands ])
+        self.frames = self.frames + 1
+        if self.delay > 0:
+          time.sleep(self.delay)
+        try:
+          os.write(master, (";".join(results) + "\n").encode("ascii"))
+        except OSError:
+          return
+
+  def interface(self, name):
+    """ Get the interface type of the named slot
+    """
+    for info in self.slots:
+      if info[0] == name:
+        return info[1]
+    return None
+
+  def process(self, command):
+    """ Process a single command and return the result
+    """
+    if command == "L":
+      return ",".join([ "%s:%s:%s" % info for info in self.slots ])
+    if command.startswith("R"):
+      name = command[1:]
+      if name not in self.values:
+        return "!Unknown slot %s" % name
+      return "%d" % self.values[name]
+    if command.startswith("W") and ("=" in command):
+      name, value = command[1:].split("=", 1)
+      if name not in self.values:
+        return "!Unknown slot %s" % name
+      try:
+        value = int(value)
+      except ValueError:
+        return "!Invalid value %s" % value
+      # Digital slots only hold 0 or 1
+      if self.interface(name) == Slot.DIGITAL:
+        value = int(value <> 0)
+      self.values[name] = value
+      return "OK"
+    return "!Unknown command %s" % command
+
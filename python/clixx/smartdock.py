@@ -1,10 +1,159 @@
 #!/usr/bin/env python
 #----------------------------------------------------------------------------
 # SmartDock (RS232 based dock) interface.
+#
+# The SmartDock protocol is line based ASCII. The host sends a frame made up
+# of one or more commands separated by ';' and terminated by a newline. The
+# dock replies with a single line containing one result per command, also
+# separated by ';'. The supported commands are:
+#
+#   L           - List the available slots. The result is a ',' separated
+#                 list of NAME:INTERFACE:SIZE entries (eg: A0:A:ST).
+#   R<slot>     - Read a value from a slot (eg: RA0). The result is the value
+#                 as a decimal integer.
+#   W<slot>=<v> - Write a value to a slot (eg: WD0=1). The result is 'OK'.
+#
+# Any command that fails returns a result starting with '!' followed by an
+# error message. The dock always executes every command in a frame, in
+# order, even if an earlier one fails.
+#
+# A frame may start with a sequence tag '@<n>' which the dock echoes back as
+# the first item of the response. This allows replies that arrive after the
+# host has given up waiting to be recognised and discarded.
 #----------------------------------------------------------------------------
 import serial
 from clixxbase import ClixxException, Dock, Slot
 
+#----------------------------------------------------------------------------
+# Protocol helpers
+#----------------------------------------------------------------------------
+
+class BatchException(ClixxException):
+  """ Raised when one or more commands in a Batch fail
+
+    The 'results' attribute holds the result of every command in the batch
+    with a ClixxException in place of the value for each command that
+    failed. All the other commands (including writes queued after a failed
+    command) have been carried out by the dock.
+  """
+
+  def __init__(self, message, results):
+    ClixxException.__init__(self, message)
+    self.results = results
+
+def parse_result(result):
+  """ Convert a single result from the dock into a value
+
+    Raises a ClixxException if the dock reported an error.
+  """
+  if result.startswith("!"):
+    raise ClixxException(result[1:])
+  if result == "OK":
+    return None
+  return int(result)
+
+#----------------------------------------------------------------------------
+# Slot implementation
+#----------------------------------------------------------------------------
+
+class SmartSlot(Slot):
+  """ A Slot on a SmartDock.
+
+    Each call to read() or write() is a round trip to the dock. Use
+    SmartDock.batch() to combine operations on multiple slots.
+  """
+
+  def __init__(self, dock, name, interface, size):
+    """ Initialise the slot
+    """
+    self.dock = dock
+    self.name = name
+    self.interface = interface
+    self.format = size
+
+  def read(self):
+    """ Read a single value from the slot
+    """
+    return parse_result(self.dock.execute(("R%s" % self.name, ))[0])
+
+  def write(self, data):
+    """ Write a single value to the slot
+    """
+    parse_result(self.dock.execute(("W%s=%d" % (self.name, data), ))[0])
+
+#----------------------------------------------------------------------------
+# Command batching
+#----------------------------------------------------------------------------
+
+class Batch:
+  """ Collects slot operations to send to the dock as a single frame.
+
+    Use as a context manager via SmartDock.batch(). The read() and write()
+    methods return the index of the operation in the results list which is
+    filled in when the block exits. Results for reads are the value read,
+    results for writes are None.
+
+    If any command fails the results are still filled in, with a
+    ClixxException in place of each failed result, and a BatchException is
+    raised. The dock carries out every other command in the batch, so all
+    writes that did not fail themselves have taken effect.
+
+      with dock.batch() as batch:
+        temp = batch.read(Dock.ANALOG_0)
+        batch.write(Dock.DIGITAL_0, 1)
+      print batch.results[temp]
+  """
+
+  def __init__(self, dock):
+    """ Initialise the batch
+    """
+    self.dock = dock
+    self.commands = list()
+    self.results = None
+
+  def read(self, name):
+    """ Queue a read from the named slot
+    """
+    self.commands.append("R%s" % name)
+    return len(self.commands) - 1
+
+  def write(self, name, data):
+    """ Queue a write to the named slot
+    """
+    self.commands.append("W%s=%d" % (name, data))
+    return len(self.commands) - 1
+
+  def send(self):
+    """ Send all the queued operations and collect the results
+    """
+    commands, self.commands = self.commands, list()
+    results = list()
+    failed = 0
+    if len(commands) > 0:
+      for result in self.dock.execute(commands):
+        try:
+          results.append(parse_result(result))
+        except ClixxException, ex:
+          results.append(ex)
+          failed = failed + 1
+    self.results = tuple(results)
+    if failed > 0:
+      raise BatchException("%d of %d commands failed." % (failed, len(commands)), self.results)
+    return self.results
+
+  def __enter__(self):
+    return self
+
+  def __exit__(self, exc_type, exc_value, traceback):
+    # Don't send anything if the block raised an exception
+    if exc_type is None:
+      self.send()
+    return False
+
+#----------------------------------------------------------------------------
+# Dock implementation
+#----------------------------------------------------------------------------
+
 class SmartDock(Dock):
   """ Implements the SmartDock protocol over a serial port.
   """
@@ -15,21 +164,72 @@ class SmartDock(Dock):
 
   def setup(self, **kwargs):
     """ Initialise this particular Dock instance
+
+      Accepts the 'port', 'baudrate' and 'timeout' (in seconds) keyword
+      arguments.
     """
-    raise ClixxException("Not implemented.")
+    self.port = serial.Serial(
+      kwargs.get("port", "/dev/ttyUSB0"),
+      kwargs.get("baudrate", 115200),
+      timeout = kwargs.get("timeout", 1.0)
+      )
+    # Find out what slots are available
+    self.slots = dict()
+    for entry in self.execute(("L", ))[0].split(","):
+      if entry == "":
+        continue
+      info = entry.split(":")
+      if len(info) <> 3:
+        raise ClixxException("Invalid slot description '%s'." % entry)
+      self.slots[info[0]] = SmartSlot(self, info[0], info[1], info[2])
 
   def done(self):
     """ Clean up the Dock instance
     """
-    pass
+    if getattr(self, "port", None) is not None:
+      self.port.close()
+      self.port = None
 
   def slot(self, name):
     """ Get a slot by it's name
     """
-    raise ClixxException("Not implemented.")
+    if not self.slots.has_key(name):
+      return None
+    return self.slots[name]
 
   def available(self):
     """ Return a list of available Slots
     """
-    raise ClixxException("Not implemented.")
+    return tuple(sorted(self.slots.keys()))
+
+  #--------------------------------------------------------------------------
+  # SmartDock specific methods
+  #--------------------------------------------------------------------------
+
+  def batch(self):
+    """ Create a new Batch to combine operations into a single round trip
+    """
+    return Batch(self)
+
+  def execute(self, commands):
+    """ Send a sequence of commands as a single frame
+
+      Returns the list of raw results, one for each command. Any responses
+      left over from earlier frames (eg: after a timeout) are discarded.
+    """
+    self.sequence = (getattr(self, "sequence", 0) + 1) % 10000
+    tag = "@%d" % self.sequence
+    self.port.flushInput()
+    self.port.write((";".join((tag, ) + tuple(commands)) + "\n").encode("ascii"))
+    while True:
+      line = self.port.readline().decode("ascii")
+      if not line.endswith("\n"):
+        raise ClixxException("Timeout waiting for response from dock.")
+      results = line.strip().split(";")
+      if results[0] == tag:
+        break
+    results = results[1:]
+    if len(results) <> len(commands):
+      raise ClixxException("Expected %d results, received %d." % (len(commands), len(results)))
+    return results
 
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+#----------------------------------------------------------------------------
+# Tests for the SmartDock interface using the pty based emulator.
+#----------------------------------------------------------------------------
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+
+from clixx.clixxbase import ClixxException, Dock
+from clixx.smartdock import SmartDock, BatchException
+from clixx.emulator import SmartDockEmulator
+
+class SmartDockTest(unittest.TestCase):
+
+  def setUp(self):
+    self.emulator = SmartDockEmulator()
+    self.emulator.start()
+    self.dock = SmartDock()
+    self.dock.setup(port = self.emulator.port, timeout = 0.5)
+
+  def tearDown(self):
+    self.dock.done()
+    self.emulator.stop()
+
+  def test_available(self):
+    self.assertEqual(self.dock.available(), (Dock.ANALOG_0, Dock.ANALOG_1, Dock.DIGITAL_0, Dock.DIGITAL_1))
+
+  def test_read_write(self):
+    self.emulator.set(Dock.ANALOG_0, 512)
+    self.assertEqual(self.dock.slot(Dock.ANALOG_0).read(), 512)
+    self.dock.slot(Dock.DIGITAL_0).write(1)
+    self.assertEqual(self.emulator.get(Dock.DIGITAL_0), 1)
+
+  def test_batch(self):
+    self.emulator.set(Dock.ANALOG_0, 100)
+    frames = self.emulator.frames
+    with self.dock.batch() as batch:
+      first = batch.read(Dock.ANALOG_0)
+      batch.write(Dock.ANALOG_1, 77)
+      second = batch.read(Dock.ANALOG_1)
+    self.assertEqual(self.emulator.frames - frames, 1)
+    self.assertEqual(batch.results, (100, None, 77))
+    self.assertEqual(batch.results[first], 100)
+    self.assertEqual(batch.results[second], 77)
+
+  def test_batch_error(self):
+    self.emulator.set(Dock.DIGITAL_0, 1)
+    batch = self.dock.batch()
+    batch.write(Dock.DIGITAL_0, 0)
+    batch.read("Z9")
+    batch.write(Dock.DIGITAL_1, 1)
+    self.assertRaises(BatchException, batch.send)
+    self.assertEqual(batch.results[0], None)
+    self.assertTrue(isinstance(batch.results[1], ClixxException))
+    self.assertEqual(batch.results[2], None)
+    # Writes either side of the failure have been applied
+    self.assertEqual(self.emulator.get(Dock.DIGITAL_0), 0)
+    self.assertEqual(self.emulator.get(Dock.DIGITAL_1), 1)
+
+  def test_late_response(self):
+    self.emulator.set(Dock.ANALOG_0, 1)
+    self.emulator.set(Dock.ANALOG_1, 2)
+    self.emulator.delay = 0.75
+    self.assertRaises(ClixxException, self.dock.slot(Dock.ANALOG_0).read)
+    # The late reply to the first read must not be taken as this one
+    self.emulator.delay = 0
+    self.assertEqual(self.dock.slot(Dock.ANALOG_1).read(), 2)
+
+if __name__ == "__main__":
+  unittest.main()